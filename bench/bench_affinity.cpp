@@ -0,0 +1,171 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "tp/thread_pool.hpp"
+
+namespace {
+
+/// Hardware cache-miss counter for this process and the threads it starts
+/// afterwards (so open it before the pool). `read()` is empty when the kernel
+/// or VM exposes no such event, or off Linux.
+class CacheMissCounter {
+public:
+    CacheMissCounter() {
+#if defined(__linux__)
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    ~CacheMissCounter() {
+#if defined(__linux__)
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+#endif
+    }
+
+    CacheMissCounter(const CacheMissCounter&) = delete;
+    CacheMissCounter& operator=(const CacheMissCounter&) = delete;
+
+    /// Call after the counted threads have been joined, so their counts are folded in.
+    std::optional<uint64_t> read() const {
+#if defined(__linux__)
+        uint64_t value = 0;
+        if (fd_ >= 0 && ::read(fd_, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) {
+            return value;
+        }
+#endif
+        return std::nullopt;
+    }
+
+private:
+    int fd_ = -1;
+};
+
+struct RunResult {
+    double seconds = 0.0;
+    tp::ThreadPool::Stats stats;
+    std::optional<uint64_t> cache_misses;
+};
+
+struct BenchConfig {
+    size_t tasks = 20000;
+    size_t shards = 16;
+    size_t shard_kb = 256;
+    size_t workers = std::thread::hardware_concurrency();
+};
+
+BenchConfig parse_args(int argc, char** argv) {
+    BenchConfig cfg;
+    if (argc > 1) cfg.tasks = static_cast<size_t>(std::stoull(argv[1]));
+    if (argc > 2) cfg.shards = static_cast<size_t>(std::stoull(argv[2]));
+    if (argc > 3) cfg.shard_kb = static_cast<size_t>(std::stoull(argv[3]));
+    if (argc > 4) cfg.workers = static_cast<size_t>(std::stoull(argv[4]));
+    if (cfg.workers == 0) cfg.workers = 1;
+    if (cfg.shards == 0) cfg.shards = 1;
+    return cfg;
+}
+
+/// Read-modify-write pass over one shard's working set, so the cost of a task
+/// depends on whether the shard is still warm in the running core's cache.
+void touch_shard(std::vector<uint64_t>& shard) {
+    for (auto& v : shard) {
+        v = v * 2654435761u + 1;
+    }
+}
+
+template <typename Submit>
+RunResult run(const BenchConfig& cfg, Submit submit) {
+    std::vector<std::vector<uint64_t>> shards(
+        cfg.shards, std::vector<uint64_t>(cfg.shard_kb * 1024 / sizeof(uint64_t), 1));
+    CacheMissCounter misses;
+    tp::ThreadPool pool(cfg.workers);
+    std::vector<std::future<void>> futures;
+    futures.reserve(cfg.tasks);
+
+    // Tasks for one shard must not overlap, so submit in waves of one task per shard.
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t done = 0; done < cfg.tasks; done += cfg.shards) {
+        futures.clear();
+        for (size_t s = 0; s < cfg.shards && done + s < cfg.tasks; ++s) {
+            auto fut_opt = submit(pool, s, [&shard = shards[s]]() { touch_shard(shard); });
+            if (fut_opt.has_value()) {
+                futures.push_back(std::move(*fut_opt));
+            }
+        }
+        for (auto& fut : futures) {
+            fut.get();
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    RunResult result;
+    result.stats = pool.stats();
+    pool.shutdown();
+    result.cache_misses = misses.read();
+
+    std::chrono::duration<double> seconds = end - start;
+    result.seconds = seconds.count();
+    return result;
+}
+
+void report(const std::string& label, const BenchConfig& cfg, const RunResult& result) {
+    std::cout << label << "_sec=" << result.seconds
+              << " tasks_per_sec=" << static_cast<double>(cfg.tasks) / result.seconds
+              << " affine_hits=" << result.stats.affine_hits
+              << " affine_steals=" << result.stats.affine_steals
+              << " locality_hit_rate=" << result.stats.locality_hit_rate << " cache_misses=";
+    if (result.cache_misses.has_value()) {
+        std::cout << *result.cache_misses;
+    } else {
+        std::cout << "n/a";
+    }
+    std::cout << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    auto cfg = parse_args(argc, argv);
+
+    std::cout << "Affinity benchmark\n";
+    std::cout << "tasks=" << cfg.tasks << " shards=" << cfg.shards
+              << " shard_kb=" << cfg.shard_kb << " workers=" << cfg.workers << "\n";
+
+    auto plain = run(cfg, [](tp::ThreadPool& pool, size_t, auto&& fn) {
+        return pool.submit(std::forward<decltype(fn)>(fn));
+    });
+    auto affine = run(cfg, [](tp::ThreadPool& pool, size_t shard, auto&& fn) {
+        return pool.submit_affine(shard, std::forward<decltype(fn)>(fn));
+    });
+
+    report("submit", cfg, plain);
+    report("submit_affine", cfg, affine);
+
+    return 0;
+}
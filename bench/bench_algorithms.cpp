@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(TP_BENCH_HAS_PAR_EXECUTION)
+#include <execution>
+#endif
+
+#include "tp/algorithms.hpp"
+#include "tp/thread_pool.hpp"
+
+namespace {
+
+struct BenchConfig {
+    size_t max_size = 10'000'000;
+    size_t workers = std::thread::hardware_concurrency();
+};
+
+BenchConfig parse_args(int argc, char** argv) {
+    BenchConfig cfg;
+    if (argc > 1) cfg.max_size = static_cast<size_t>(std::stoull(argv[1]));
+    if (argc > 2) cfg.workers = static_cast<size_t>(std::stoull(argv[2]));
+    if (cfg.workers == 0) cfg.workers = 1;
+    return cfg;
+}
+
+/// Best-of-three wall time in milliseconds; `setup` restores the input between runs.
+template <typename Setup, typename Fn>
+double time_ms(Setup setup, Fn fn) {
+    double best = 0.0;
+    for (int rep = 0; rep < 3; ++rep) {
+        setup();
+        auto start = std::chrono::high_resolution_clock::now();
+        fn();
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> ms = end - start;
+        if (rep == 0 || ms.count() < best) best = ms.count();
+    }
+    return best;
+}
+
+void print_row(const std::string& algo, size_t size, const std::string& impl, double ms) {
+    std::cout << algo << " size=" << size << " impl=" << impl << " ms=" << ms << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    auto cfg = parse_args(argc, argv);
+
+    std::cout << "Algorithms benchmark\n";
+    std::cout << "max_size=" << cfg.max_size << " workers=" << cfg.workers << "\n";
+
+    tp::ThreadPool pool(cfg.workers);
+    std::mt19937_64 rng(7);
+    volatile int64_t sink = 0;
+
+    for (size_t size = 10'000; size <= cfg.max_size; size *= 10) {
+        std::vector<int64_t> input(size);
+        for (auto& v : input) v = static_cast<int64_t>(rng() >> 1);
+        std::vector<int64_t> work(size);
+        auto reset = [&] { std::copy(input.begin(), input.end(), work.begin()); };
+        auto none = [] {};
+
+        print_row("sort", size, "std", time_ms(reset, [&] { std::sort(work.begin(), work.end()); }));
+        print_row("sort", size, "tp", time_ms(reset, [&] { tp::parallel_sort(pool, work.begin(), work.end()); }));
+#if defined(TP_BENCH_HAS_PAR_EXECUTION)
+        print_row("sort", size, "std_par",
+                  time_ms(reset, [&] { std::sort(std::execution::par, work.begin(), work.end()); }));
+#endif
+
+        print_row("inclusive_scan", size, "std", time_ms(none, [&] {
+            std::inclusive_scan(input.begin(), input.end(), work.begin());
+        }));
+        print_row("inclusive_scan", size, "tp", time_ms(none, [&] {
+            tp::parallel_inclusive_scan(pool, input.begin(), input.end(), work.begin());
+        }));
+#if defined(TP_BENCH_HAS_PAR_EXECUTION)
+        print_row("inclusive_scan", size, "std_par", time_ms(none, [&] {
+            std::inclusive_scan(std::execution::par, input.begin(), input.end(), work.begin());
+        }));
+#endif
+
+        auto square = [](int64_t v) { return (v & 0xffff) * (v & 0xffff); };
+        print_row("transform_reduce", size, "std", time_ms(none, [&] {
+            sink = std::transform_reduce(input.begin(), input.end(), int64_t{0}, std::plus<>{}, square);
+        }));
+        print_row("transform_reduce", size, "tp", time_ms(none, [&] {
+            sink = tp::parallel_transform_reduce(pool, input.begin(), input.end(), int64_t{0},
+                                                 std::plus<>{}, square);
+        }));
+#if defined(TP_BENCH_HAS_PAR_EXECUTION)
+        print_row("transform_reduce", size, "std_par", time_ms(none, [&] {
+            sink = std::transform_reduce(std::execution::par, input.begin(), input.end(), int64_t{0},
+                                         std::plus<>{}, square);
+        }));
+#endif
+    }
+
+    pool.shutdown();
+    return 0;
+}
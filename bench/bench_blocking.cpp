@@ -0,0 +1,91 @@
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <optional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_utils.hpp"
+#include "tp/thread_pool.hpp"
+
+namespace {
+
+struct BenchConfig {
+    size_t tasks = 2000;
+    size_t blocking_every = 4;
+    size_t block_ms = 5;
+    size_t work_iters = 20000;
+    size_t workers = std::thread::hardware_concurrency();
+};
+
+BenchConfig parse_args(int argc, char** argv) {
+    BenchConfig cfg;
+    if (argc > 1) cfg.tasks = static_cast<size_t>(std::stoull(argv[1]));
+    if (argc > 2) cfg.blocking_every = static_cast<size_t>(std::stoull(argv[2]));
+    if (argc > 3) cfg.block_ms = static_cast<size_t>(std::stoull(argv[3]));
+    if (argc > 4) cfg.work_iters = static_cast<size_t>(std::stoull(argv[4]));
+    if (argc > 5) cfg.workers = static_cast<size_t>(std::stoull(argv[5]));
+    if (cfg.workers == 0) cfg.workers = 1;
+    if (cfg.blocking_every == 0) cfg.blocking_every = 1;
+    return cfg;
+}
+
+/// Every `blocking_every`-th task sleeps (standing in for a file read or a wait on
+/// external work); the rest are CPU-bound. With `scoped`, the sleep runs inside a
+/// `BlockingScope` so the pool can start compensating workers.
+double run(const BenchConfig& cfg, bool scoped) {
+    tp::ThreadPool pool(cfg.workers);
+    std::vector<std::future<void>> futures;
+    futures.reserve(cfg.tasks);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < cfg.tasks; ++i) {
+        std::optional<std::future<void>> fut_opt;
+        if (i % cfg.blocking_every == 0) {
+            fut_opt = pool.submit([&pool, scoped, ms = cfg.block_ms]() {
+                auto block = [ms] { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); };
+                if (scoped) {
+                    pool.run_blocking(block);
+                } else {
+                    block();
+                }
+            });
+        } else {
+            fut_opt = pool.submit([iters = cfg.work_iters]() { bench::busy_work(iters); });
+        }
+        if (fut_opt.has_value()) {
+            futures.push_back(std::move(*fut_opt));
+        }
+    }
+    for (auto& fut : futures) {
+        fut.get();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    pool.shutdown();
+
+    std::chrono::duration<double> seconds = end - start;
+    return seconds.count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    auto cfg = parse_args(argc, argv);
+
+    std::cout << "Blocking benchmark\n";
+    std::cout << "tasks=" << cfg.tasks << " blocking_every=" << cfg.blocking_every
+              << " block_ms=" << cfg.block_ms << " work_iters=" << cfg.work_iters
+              << " workers=" << cfg.workers << "\n";
+
+    auto plain_sec = run(cfg, false);
+    auto scoped_sec = run(cfg, true);
+
+    std::cout << "plain_sec=" << plain_sec
+              << " tasks_per_sec=" << static_cast<double>(cfg.tasks) / plain_sec << "\n";
+    std::cout << "blocking_scope_sec=" << scoped_sec
+              << " tasks_per_sec=" << static_cast<double>(cfg.tasks) / scoped_sec << "\n";
+
+    return 0;
+}
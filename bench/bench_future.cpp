@@ -0,0 +1,60 @@
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "bench_utils.hpp"
+#include "tp/thread_pool.hpp"
+
+namespace {
+
+struct BenchConfig {
+    size_t round_trips = 20000;
+    size_t workers = std::thread::hardware_concurrency();
+};
+
+BenchConfig parse_args(int argc, char** argv) {
+    BenchConfig cfg;
+    if (argc > 1) cfg.round_trips = static_cast<size_t>(std::stoull(argv[1]));
+    if (argc > 2) cfg.workers = static_cast<size_t>(std::stoull(argv[2]));
+    if (cfg.workers == 0) cfg.workers = 1;
+    return cfg;
+}
+
+/// Submit a trivial task and immediately `get()` it, one round trip at a time.
+template <template <typename> class FutureT>
+std::vector<double> run_round_trips(const BenchConfig& cfg) {
+    tp::ThreadPool pool(cfg.workers);
+    std::vector<double> lat_us;
+    lat_us.reserve(cfg.round_trips);
+
+    for (size_t i = 0; i < cfg.round_trips; ++i) {
+        auto start = std::chrono::high_resolution_clock::now();
+        auto fut_opt = pool.submit<FutureT>([i]() { return i; });
+        auto value = fut_opt->get();
+        auto end = std::chrono::high_resolution_clock::now();
+        if (value != i) {
+            std::cerr << "unexpected result\n";
+        }
+        std::chrono::duration<double, std::micro> dur = end - start;
+        lat_us.push_back(dur.count());
+    }
+    pool.shutdown();
+    return lat_us;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    auto cfg = parse_args(argc, argv);
+
+    std::cout << "Future round-trip benchmark\n";
+    std::cout << "round_trips=" << cfg.round_trips << " workers=" << cfg.workers << "\n";
+
+    bench::report("std_future", run_round_trips<std::future>(cfg));
+    bench::report("tp_future", run_round_trips<tp::Future>(cfg));
+
+    return 0;
+}
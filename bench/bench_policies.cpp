@@ -0,0 +1,114 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_utils.hpp"
+#include "tp/basic_thread_pool.hpp"
+#include "tp/thread_pool.hpp"
+
+namespace {
+
+struct BenchConfig {
+    size_t tasks = 200000;
+    size_t work_iters = 0;
+    size_t workers = std::thread::hardware_concurrency();
+};
+
+BenchConfig parse_args(int argc, char** argv) {
+    BenchConfig cfg;
+    if (argc > 1) cfg.tasks = static_cast<size_t>(std::stoull(argv[1]));
+    if (argc > 2) cfg.work_iters = static_cast<size_t>(std::stoull(argv[2]));
+    if (argc > 3) cfg.workers = static_cast<size_t>(std::stoull(argv[3]));
+    if (cfg.workers == 0) cfg.workers = 1;
+    return cfg;
+}
+
+double seconds_since(std::chrono::high_resolution_clock::time_point start) {
+    std::chrono::duration<double> seconds = std::chrono::high_resolution_clock::now() - start;
+    return seconds.count();
+}
+
+/// Fire-and-forget throughput: post tiny tasks, then wait for a completion counter.
+template <typename Pool>
+double run_post(const BenchConfig& cfg) {
+    Pool pool(cfg.workers);
+    std::atomic<size_t> done{0};
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < cfg.tasks; ++i) {
+        pool.post([&done, iters = cfg.work_iters]() {
+            bench::busy_work(iters);
+            done.fetch_add(1, std::memory_order_release);
+        });
+    }
+    while (done.load(std::memory_order_acquire) < cfg.tasks) {
+        std::this_thread::yield();
+    }
+    auto sec = seconds_since(start);
+    pool.shutdown();
+    return sec;
+}
+
+/// Future-returning throughput, comparable with `ThreadPool::submit`.
+template <typename Pool>
+double run_submit(const BenchConfig& cfg) {
+    Pool pool(cfg.workers);
+    std::vector<std::future<void>> futures;
+    futures.reserve(cfg.tasks);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < cfg.tasks; ++i) {
+        auto fut_opt = pool.submit([iters = cfg.work_iters]() { bench::busy_work(iters); });
+        if (fut_opt.has_value()) {
+            futures.push_back(std::move(*fut_opt));
+        }
+    }
+    for (auto& fut : futures) {
+        fut.get();
+    }
+    auto sec = seconds_since(start);
+    pool.shutdown();
+    return sec;
+}
+
+void print_row(const std::string& label, const std::string& mode, size_t tasks, double sec) {
+    std::cout << label << " mode=" << mode << " sec=" << sec
+              << " tasks_per_sec=" << static_cast<double>(tasks) / sec << "\n";
+}
+
+template <typename Pool>
+void run_both(const BenchConfig& cfg, const std::string& label) {
+    print_row(label, "post", cfg.tasks, run_post<Pool>(cfg));
+    print_row(label, "submit", cfg.tasks, run_submit<Pool>(cfg));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    using namespace tp::policy;
+    auto cfg = parse_args(argc, argv);
+
+    std::cout << "Policy benchmark\n";
+    std::cout << "tasks=" << cfg.tasks << " work_iters=" << cfg.work_iters
+              << " workers=" << cfg.workers << "\n";
+
+    print_row("thread_pool", "submit", cfg.tasks, run_submit<tp::ThreadPool>(cfg));
+    run_both<tp::BasicThreadPool<>>(cfg, "mutex_blocking_atomic_function");
+    run_both<tp::BasicThreadPool<MutexQueue, BlockingIdle, NoStats, FunctionTask>>(
+        cfg, "mutex_blocking_nostats_function");
+    run_both<tp::BasicThreadPool<MutexQueue, BlockingIdle, AtomicStats, InplaceTask<64>>>(
+        cfg, "mutex_blocking_atomic_inplace");
+    run_both<tp::BasicThreadPool<RingQueue<4096>, BlockingIdle, AtomicStats, FunctionTask>>(
+        cfg, "ring_blocking_atomic_function");
+    run_both<tp::BasicThreadPool<RingQueue<4096>, BlockingIdle, NoStats, InplaceTask<64>>>(
+        cfg, "ring_blocking_nostats_inplace");
+    run_both<tp::BasicThreadPool<RingQueue<4096>, SpinIdle, NoStats, InplaceTask<64>>>(
+        cfg, "ring_spin_nostats_inplace");
+
+    return 0;
+}
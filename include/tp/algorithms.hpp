@@ -0,0 +1,338 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "tp/thread_pool.hpp"
+
+/// Data-parallel algorithms that split a random-access range into chunks and
+/// run them on a `ThreadPool`. Call them from outside the pool: the caller
+/// blocks on the chunk futures (and works on one chunk itself), so calling from
+/// a worker can starve the pool. Callables run concurrently and must be
+/// thread-safe. Inner loops are plain indexed loops over one chunk so the
+/// compiler can auto-vectorize them when optimizations are enabled.
+namespace tp {
+
+namespace detail {
+
+/// Below this many elements per chunk, task overhead outweighs the parallelism.
+inline constexpr size_t kMinChunk = 4096;
+
+template <typename It>
+inline constexpr bool is_random_access_v = std::is_base_of_v<
+    std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+
+inline size_t chunk_count(const ThreadPool& pool, size_t n) {
+    const size_t workers = std::max<size_t>(pool.worker_count(), 1);
+    const size_t by_size = (n + kMinChunk - 1) / kMinChunk;
+    return std::max<size_t>(1, std::min(workers * 4, by_size));
+}
+
+/// Balanced split of `[0, n)`: chunk `c` covers `[chunk_begin(c), chunk_begin(c + 1))`.
+inline size_t chunk_begin(size_t n, size_t chunks, size_t c) {
+    return c * n / chunks;
+}
+
+/// Run `fn(chunk, begin, end)` for each chunk of `[0, n)` and wait for all of them.
+/// The caller runs the last chunk itself; chunks the pool rejects (shutdown) also run
+/// inline. The first exception is rethrown only after every chunk has finished, so
+/// no task outlives the caller's stack frame.
+template <typename Fn>
+void for_each_chunk(ThreadPool& pool, size_t n, size_t chunks, Fn&& fn) {
+    if (n == 0 || chunks == 0) return;
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(chunks - 1);
+    std::exception_ptr error;
+    auto run_inline = [&](size_t c) {
+        try {
+            fn(c, chunk_begin(n, chunks, c), chunk_begin(n, chunks, c + 1));
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+    };
+
+    for (size_t c = 0; c + 1 < chunks; ++c) {
+        auto fut_opt = pool.submit([&fn, n, chunks, c]() {
+            fn(c, chunk_begin(n, chunks, c), chunk_begin(n, chunks, c + 1));
+        });
+        if (fut_opt.has_value()) {
+            futures.push_back(std::move(*fut_opt));
+        } else {
+            run_inline(c);
+        }
+    }
+    run_inline(chunks - 1);
+
+    for (auto& fut : futures) {
+        try {
+            fut.get();
+        } catch (...) {
+            if (!error) error = std::current_exception();
+        }
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+/// Sequential transform-reduce over `len >= 1` elements. Four independent
+/// accumulators break the loop-carried dependency so the loop can be unrolled
+/// and vectorized (`reduce` must be associative and commutative, as for
+/// `std::transform_reduce`).
+template <typename T, typename It, typename Reduce, typename Transform>
+T transform_reduce_chunk(It it, size_t len, Reduce& reduce, Transform& transform) {
+    if (len < 8) {
+        T acc = transform(it[0]);
+        for (size_t i = 1; i < len; ++i) acc = reduce(std::move(acc), transform(it[i]));
+        return acc;
+    }
+    T acc0 = transform(it[0]);
+    T acc1 = transform(it[1]);
+    T acc2 = transform(it[2]);
+    T acc3 = transform(it[3]);
+    size_t i = 4;
+    for (; i + 4 <= len; i += 4) {
+        acc0 = reduce(std::move(acc0), transform(it[i]));
+        acc1 = reduce(std::move(acc1), transform(it[i + 1]));
+        acc2 = reduce(std::move(acc2), transform(it[i + 2]));
+        acc3 = reduce(std::move(acc3), transform(it[i + 3]));
+    }
+    for (; i < len; ++i) acc0 = reduce(std::move(acc0), transform(it[i]));
+    return reduce(reduce(std::move(acc0), std::move(acc1)), reduce(std::move(acc2), std::move(acc3)));
+}
+
+/// Merge `src[a_begin, a_end)` and `src[b_begin, b_end)` into `dst + out`.
+struct MergeJob {
+    size_t a_begin;
+    size_t a_end;
+    size_t b_begin;
+    size_t b_end;
+    size_t out;
+};
+
+/// One bottom-up merge pass: merges adjacent sorted runs (boundaries in `runs`)
+/// from `src` into `dst` and returns the boundaries of the merged runs. When there
+/// are fewer pairs than workers, each pair merge is split at co-ranked positions
+/// (binary search of A's split values in B) so the last passes stay parallel.
+template <typename SrcIt, typename DstIt, typename Compare>
+std::vector<size_t> merge_pass(ThreadPool& pool, SrcIt src, DstIt dst,
+                               const std::vector<size_t>& runs, Compare& comp) {
+    const size_t run_count = runs.size() - 1;
+    const size_t pairs = (run_count + 1) / 2;
+    const size_t workers = std::max<size_t>(pool.worker_count(), 1);
+    const size_t parts_per_pair = std::max<size_t>(1, (workers * 2 + pairs - 1) / pairs);
+
+    std::vector<MergeJob> jobs;
+    std::vector<size_t> merged{0};
+    for (size_t r = 0; r < run_count; r += 2) {
+        const size_t a_begin = runs[r];
+        const size_t a_end = runs[r + 1];
+        const size_t b_end = r + 2 <= run_count ? runs[r + 2] : a_end;
+        const size_t a_len = a_end - a_begin;
+        const size_t parts = std::min(parts_per_pair, std::max<size_t>(1, a_len / kMinChunk));
+
+        size_t prev_a = a_begin;
+        size_t prev_b = a_end;
+        for (size_t p = 1; p <= parts; ++p) {
+            size_t next_a = a_end;
+            size_t next_b = b_end;
+            if (p < parts) {
+                next_a = a_begin + p * a_len / parts;
+                next_b = static_cast<size_t>(
+                    std::lower_bound(src + prev_b, src + b_end, src[next_a], comp) - src);
+            }
+            jobs.push_back({prev_a, next_a, prev_b, next_b, prev_a + (prev_b - a_end)});
+            prev_a = next_a;
+            prev_b = next_b;
+        }
+        merged.push_back(b_end);
+    }
+
+    for_each_chunk(pool, jobs.size(), jobs.size(), [&](size_t, size_t begin, size_t end) {
+        for (size_t j = begin; j < end; ++j) {
+            const auto& job = jobs[j];
+            std::merge(std::make_move_iterator(src + job.a_begin),
+                       std::make_move_iterator(src + job.a_end),
+                       std::make_move_iterator(src + job.b_begin),
+                       std::make_move_iterator(src + job.b_end), dst + job.out, comp);
+        }
+    });
+    return merged;
+}
+
+}  // namespace detail
+
+/// Parallel `std::transform`: writes `op(*it)` for every element to `d_first`.
+/// Returns the iterator past the last element written.
+template <typename InIt, typename OutIt, typename UnaryOp>
+OutIt parallel_transform(ThreadPool& pool, InIt first, InIt last, OutIt d_first, UnaryOp op) {
+    static_assert(detail::is_random_access_v<InIt> && detail::is_random_access_v<OutIt>,
+                  "parallel_transform requires random-access iterators");
+    const auto n = static_cast<size_t>(std::distance(first, last));
+    detail::for_each_chunk(pool, n, detail::chunk_count(pool, n), [&](size_t, size_t begin, size_t end) {
+        auto in = first + begin;
+        auto out = d_first + begin;
+        const size_t len = end - begin;
+        for (size_t i = 0; i < len; ++i) {
+            out[i] = op(in[i]);
+        }
+    });
+    return d_first + n;
+}
+
+/// Parallel `std::transform_reduce`: folds `transform(*it)` into `init` with `reduce`.
+/// Like the standard version, `reduce` must be associative and commutative because
+/// chunks are combined in an unspecified grouping.
+template <typename It, typename T, typename Reduce, typename Transform>
+T parallel_transform_reduce(ThreadPool& pool, It first, It last, T init, Reduce reduce,
+                            Transform transform) {
+    static_assert(detail::is_random_access_v<It>,
+                  "parallel_transform_reduce requires random-access iterators");
+    const auto n = static_cast<size_t>(std::distance(first, last));
+    const size_t chunks = detail::chunk_count(pool, n);
+    std::vector<std::optional<T>> partials(chunks);
+    detail::for_each_chunk(pool, n, chunks, [&](size_t c, size_t begin, size_t end) {
+        partials[c] = detail::transform_reduce_chunk<T>(first + begin, end - begin, reduce, transform);
+    });
+
+    for (auto& partial : partials) {
+        if (partial.has_value()) init = reduce(std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+/// Convenience overload: `parallel_transform_reduce(pool, first, last, init, std::plus<>{}, identity)`.
+template <typename It, typename T>
+T parallel_reduce(ThreadPool& pool, It first, It last, T init) {
+    return parallel_transform_reduce(pool, first, last, std::move(init), std::plus<>{},
+                                     [](const auto& v) { return v; });
+}
+
+/// Parallel `std::inclusive_scan` using two passes: each chunk is reduced, the chunk
+/// totals are scanned on the caller, then each chunk is scanned again seeded with
+/// its carry. `d_first` may equal `first` (in-place scan).
+template <typename InIt, typename OutIt, typename BinaryOp = std::plus<>>
+OutIt parallel_inclusive_scan(ThreadPool& pool, InIt first, InIt last, OutIt d_first,
+                              BinaryOp op = {}) {
+    static_assert(detail::is_random_access_v<InIt> && detail::is_random_access_v<OutIt>,
+                  "parallel_inclusive_scan requires random-access iterators");
+    using T = typename std::iterator_traits<InIt>::value_type;
+    const auto n = static_cast<size_t>(std::distance(first, last));
+    const size_t chunks = detail::chunk_count(pool, n);
+    if (n == 0) return d_first;
+
+    std::vector<std::optional<T>> carries(chunks);
+    detail::for_each_chunk(pool, n, chunks, [&](size_t c, size_t begin, size_t end) {
+        auto in = first + begin;
+        T acc = in[0];
+        for (size_t i = 1; i < end - begin; ++i) acc = op(std::move(acc), in[i]);
+        carries[c] = std::move(acc);
+    });
+
+    // Turn chunk totals into exclusive carries: chunk 0 has none.
+    std::optional<T> running;
+    for (auto& carry : carries) {
+        std::optional<T> total = std::move(carry);
+        carry = running;
+        if (total.has_value()) {
+            running = running.has_value() ? op(std::move(*running), std::move(*total)) : std::move(*total);
+        }
+    }
+
+    detail::for_each_chunk(pool, n, chunks, [&](size_t c, size_t begin, size_t end) {
+        auto in = first + begin;
+        auto out = d_first + begin;
+        T acc = carries[c].has_value() ? op(*carries[c], in[0]) : T(in[0]);
+        out[0] = acc;
+        for (size_t i = 1; i < end - begin; ++i) {
+            acc = op(std::move(acc), in[i]);
+            out[i] = acc;
+        }
+    });
+    return d_first + n;
+}
+
+/// Parallel `std::exclusive_scan`: element `i` of the output is `init` combined with
+/// the first `i` inputs. Same two-pass scheme as `parallel_inclusive_scan`.
+template <typename InIt, typename OutIt, typename T, typename BinaryOp = std::plus<>>
+OutIt parallel_exclusive_scan(ThreadPool& pool, InIt first, InIt last, OutIt d_first, T init,
+                              BinaryOp op = {}) {
+    static_assert(detail::is_random_access_v<InIt> && detail::is_random_access_v<OutIt>,
+                  "parallel_exclusive_scan requires random-access iterators");
+    const auto n = static_cast<size_t>(std::distance(first, last));
+    const size_t chunks = detail::chunk_count(pool, n);
+    if (n == 0) return d_first;
+
+    std::vector<std::optional<T>> carries(chunks);
+    detail::for_each_chunk(pool, n, chunks, [&](size_t c, size_t begin, size_t end) {
+        auto in = first + begin;
+        T acc = in[0];
+        for (size_t i = 1; i < end - begin; ++i) acc = op(std::move(acc), in[i]);
+        carries[c] = std::move(acc);
+    });
+
+    T running = std::move(init);
+    for (auto& carry : carries) {
+        T total = std::move(*carry);
+        carry = running;
+        running = op(std::move(running), std::move(total));
+    }
+
+    detail::for_each_chunk(pool, n, chunks, [&](size_t c, size_t begin, size_t end) {
+        auto in = first + begin;
+        auto out = d_first + begin;
+        T acc = std::move(*carries[c]);
+        for (size_t i = 0; i < end - begin; ++i) {
+            T value = in[i];  // read before writing so in-place scans stay correct
+            out[i] = acc;
+            acc = op(std::move(acc), std::move(value));
+        }
+    });
+    return d_first + n;
+}
+
+/// Parallel merge sort: chunks are sorted with `std::sort` on the pool, then merged
+/// bottom-up, ping-ponging between the range and a scratch buffer. Not stable. The
+/// value type must be default-constructible and move-assignable.
+template <typename It, typename Compare = std::less<>>
+void parallel_sort(ThreadPool& pool, It first, It last, Compare comp = {}) {
+    static_assert(detail::is_random_access_v<It>, "parallel_sort requires random-access iterators");
+    using T = typename std::iterator_traits<It>::value_type;
+    const auto n = static_cast<size_t>(std::distance(first, last));
+    const size_t chunks = detail::chunk_count(pool, n);
+    if (chunks <= 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    detail::for_each_chunk(pool, n, chunks, [&](size_t, size_t begin, size_t end) {
+        std::sort(first + begin, first + end, comp);
+    });
+
+    std::vector<size_t> runs;
+    runs.reserve(chunks + 1);
+    for (size_t c = 0; c <= chunks; ++c) runs.push_back(detail::chunk_begin(n, chunks, c));
+
+    std::vector<T> buffer(n);
+    bool in_buffer = false;
+    while (runs.size() > 2) {
+        runs = in_buffer ? detail::merge_pass(pool, buffer.begin(), first, runs, comp)
+                         : detail::merge_pass(pool, first, buffer.begin(), runs, comp);
+        in_buffer = !in_buffer;
+    }
+
+    if (in_buffer) {
+        detail::for_each_chunk(pool, n, chunks, [&](size_t, size_t begin, size_t end) {
+            std::move(buffer.begin() + begin, buffer.begin() + end, first + begin);
+        });
+    }
+}
+
+}  // namespace tp
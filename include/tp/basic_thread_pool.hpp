@@ -0,0 +1,170 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "tp/pool_policies.hpp"
+#include "tp/stop_token.hpp"
+
+namespace tp {
+
+/// Header-only fixed-size pool whose queue, idle strategy, instrumentation, and
+/// task representation are chosen at compile time (see `tp/pool_policies.hpp`).
+/// Disabled features cost nothing: `NoStats` hooks are empty, `SpinIdle` never
+/// notifies, and `InplaceTask` never allocates. The defaults reproduce
+/// `ThreadPool`'s shared-queue behavior, but `ThreadPool` is not an alias for
+/// them. Affinity, compensating workers, and `tp::Future` helping all live in its
+/// scheduler, so it stays a separate compiled class (docs/design_decisions.md §18).
+///
+/// Shutdown semantics match `ThreadPool`: queued tasks drain, new ones are rejected.
+template <typename QueuePolicy = policy::MutexQueue,
+          typename IdlePolicy = policy::BlockingIdle,
+          typename StatsPolicy = policy::AtomicStats,
+          typename TaskPolicy = policy::FunctionTask>
+class BasicThreadPool {
+public:
+    using Task = typename TaskPolicy::Task;
+    using Stats = BasicPoolStats;
+
+    explicit BasicThreadPool(size_t worker_count = std::thread::hardware_concurrency()) {
+        if (worker_count == 0) {
+            worker_count = 1;
+        }
+        workers_.reserve(worker_count);
+        for (size_t i = 0; i < worker_count; ++i) {
+            workers_.emplace_back([this]() { run_worker(); });
+        }
+    }
+
+    BasicThreadPool(const BasicThreadPool&) = delete;
+    BasicThreadPool& operator=(const BasicThreadPool&) = delete;
+    BasicThreadPool(BasicThreadPool&&) = delete;
+    BasicThreadPool& operator=(BasicThreadPool&&) = delete;
+
+    ~BasicThreadPool() { shutdown(); }
+
+    /// Schedule a callable with arguments. Returns a future when accepted,
+    /// or `std::nullopt` if the pool is shutting down.
+    template <typename Callable, typename... Args>
+    auto submit(Callable&& callable, Args&&... args)
+        -> std::optional<std::future<std::invoke_result_t<Callable, Args...>>> {
+        using Result = std::invoke_result_t<Callable, Args...>;
+        std::packaged_task<Result()> task(
+            std::bind(std::forward<Callable>(callable), std::forward<Args>(args)...));
+        auto future = task.get_future();
+        if (!push(TaskPolicy::make(std::move(task)))) {
+            return std::nullopt;
+        }
+        return future;
+    }
+
+    /// Fire-and-forget submission without a future (and so without the shared
+    /// state allocation). Returns `false` if the pool is shutting down.
+    template <typename Callable, typename... Args>
+    bool post(Callable&& callable, Args&&... args) {
+        if constexpr (sizeof...(Args) == 0) {
+            return push(TaskPolicy::make(std::forward<Callable>(callable)));
+        } else {
+            return push(TaskPolicy::make(
+                std::bind(std::forward<Callable>(callable), std::forward<Args>(args)...)));
+        }
+    }
+
+    /// Stop accepting work, drain queued tasks, and join the workers.
+    void shutdown() {
+        const uint64_t prev = state_.fetch_or(kStopBit, std::memory_order_acq_rel);
+        if ((prev & kStopBit) != 0) {
+            return;
+        }
+        stop_source_.request_stop();
+        idle_.notify_all();
+
+        const auto current_id = std::this_thread::get_id();
+        for (auto& worker : workers_) {
+            if (!worker.joinable()) {
+                continue;
+            }
+            if (worker.get_id() == current_id) {
+                worker.detach();
+                continue;
+            }
+            worker.join();
+        }
+    }
+
+    bool is_shutdown() const noexcept {
+        return (state_.load(std::memory_order_acquire) & kStopBit) != 0;
+    }
+
+    StopToken get_stop_token() const noexcept { return stop_source_.get_token(); }
+
+    Stats stats() const noexcept {
+        Stats snapshot;
+        stats_.fill(snapshot);
+        snapshot.queued = queue_.size();
+        snapshot.workers = workers_.size();
+        return snapshot;
+    }
+
+private:
+    using Queue = typename QueuePolicy::template queue<Task>;
+
+    /// `state_` packs the stop flag with a count of submits between their
+    /// stop check and their push, so workers never exit while a push is landing.
+    static constexpr uint64_t kStopBit = uint64_t{1} << 63;
+
+    bool push(Task task) {
+        const uint64_t prev = state_.fetch_add(1, std::memory_order_acquire);
+        if ((prev & kStopBit) != 0) {
+            state_.fetch_sub(1, std::memory_order_release);
+            stats_.on_reject();
+            return false;
+        }
+
+        stats_.on_submit();
+        while (!queue_.try_push(std::move(task))) {
+            std::this_thread::yield();  // bounded queue is full: back off until a worker pops
+        }
+        state_.fetch_sub(1, std::memory_order_release);
+        idle_.notify_one();
+        return true;
+    }
+
+    void run_worker() {
+        while (true) {
+            auto task = queue_.try_pop();
+            if (task.has_value()) {
+                (*task)();
+                stats_.on_complete();
+                continue;
+            }
+            const uint64_t state = state_.load(std::memory_order_acquire);
+            if ((state & kStopBit) != 0) {
+                if (state == kStopBit && queue_.empty()) {
+                    break;
+                }
+                std::this_thread::yield();  // a submit is mid-push; pick it up next round
+                continue;
+            }
+            idle_.wait([this]() {
+                return !queue_.empty() || (state_.load(std::memory_order_acquire) & kStopBit) != 0;
+            });
+        }
+    }
+
+    Queue queue_;
+    IdlePolicy idle_;
+    [[no_unique_address]] StatsPolicy stats_;
+    StopSource stop_source_;
+    std::atomic<uint64_t> state_{0};
+    std::vector<std::thread> workers_;
+};
+
+}  // namespace tp
@@ -0,0 +1,332 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace tp {
+
+class ThreadPool;
+template <typename T>
+class Future;
+template <typename T>
+class Promise;
+
+namespace detail {
+
+/// Runs one queued task of the pool whose worker is calling, if any.
+/// Returns `false` off-pool or when there is nothing to run. Defined in
+/// `src/thread_pool.cpp` so waiting workers can help instead of idling.
+bool help_current_pool();
+
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+/// Polls `FutureState::wait()` spends before helping or parking. None on a single
+/// CPU: the producer cannot run while we spin, so spinning only delays it.
+inline int spin_limit() noexcept {
+    static const int limit = std::thread::hardware_concurrency() > 1 ? 64 : 0;
+    return limit;
+}
+
+/// Shared state of a `Future`/`Promise` pair: one atomic state word, a
+/// reference count, and the result stored inline (no separate allocation,
+/// mutex, or condition variable). Waiters park with `std::atomic::wait`
+/// only after setting `kWaiter`, so an uncontended `set` never notifies.
+template <typename T>
+class FutureState {
+public:
+    static constexpr uint32_t kEmpty = 0;
+    static constexpr uint32_t kWaiter = 1;
+    static constexpr uint32_t kValue = 2;
+    static constexpr uint32_t kError = 4;
+    static constexpr uint32_t kReady = kValue | kError;
+
+    FutureState() = default;
+    FutureState(const FutureState&) = delete;
+    FutureState& operator=(const FutureState&) = delete;
+
+    virtual ~FutureState() {
+        if ((state_.load(std::memory_order_relaxed) & kValue) != 0) {
+            if constexpr (!std::is_void_v<T>) {
+                value_ptr()->~T();
+            }
+        }
+    }
+
+    /// Drops one owner; the last one frees the state.
+    void release() noexcept {
+        if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    bool ready() const noexcept {
+        return (state_.load(std::memory_order_acquire) & kReady) != 0;
+    }
+
+    /// Single producer: the promise or the pool task, never both.
+    template <typename... V>
+    void set_value(V&&... value) {
+        ensure_unsatisfied();
+        if constexpr (!std::is_void_v<T>) {
+            ::new (static_cast<void*>(storage_)) T(std::forward<V>(value)...);
+        }
+        publish(kValue);
+    }
+
+    void set_exception(std::exception_ptr error) {
+        ensure_unsatisfied();
+        error_ = std::move(error);
+        publish(kError);
+    }
+
+    /// Spin briefly (see `spin_limit()`), then run other tasks of the caller's
+    /// pool (when called on a worker), then park on the state word.
+    void wait() const {
+        const int limit = spin_limit();
+        for (int i = 0; i < limit; ++i) {
+            if (ready()) return;
+            cpu_relax();
+        }
+        while (!ready()) {
+            if (help_current_pool()) continue;
+
+            uint32_t observed = state_.load(std::memory_order_acquire);
+            if ((observed & kReady) != 0) return;
+            if ((observed & kWaiter) == 0 &&
+                !state_.compare_exchange_weak(observed, observed | kWaiter,
+                                              std::memory_order_acq_rel)) {
+                continue;
+            }
+            state_.wait(observed | kWaiter, std::memory_order_acquire);
+        }
+    }
+
+    /// Moves the result out (or rethrows the stored exception). Call once, after `wait()`.
+    T take() {
+        if ((state_.load(std::memory_order_acquire) & kError) != 0) {
+            std::rethrow_exception(error_);
+        }
+        if constexpr (!std::is_void_v<T>) {
+            return std::move(*value_ptr());
+        }
+    }
+
+protected:
+    /// Owned by the future and by the producer (promise or pool task).
+    std::atomic<uint32_t> refs_{2};
+
+private:
+    void ensure_unsatisfied() const {
+        if (ready()) {
+            throw std::future_error(std::future_errc::promise_already_satisfied);
+        }
+    }
+
+    void publish(uint32_t outcome) noexcept {
+        const uint32_t prev = state_.exchange(outcome, std::memory_order_acq_rel);
+        if ((prev & kWaiter) != 0) {
+            state_.notify_all();
+        }
+    }
+
+    T* value_ptr() noexcept { return std::launder(reinterpret_cast<T*>(storage_)); }
+
+    using Stored = std::conditional_t<std::is_void_v<T>, char, T>;
+
+    mutable std::atomic<uint32_t> state_{kEmpty};
+    alignas(Stored) unsigned char storage_[sizeof(Stored)];
+    std::exception_ptr error_;
+};
+
+/// A pool task fused with its result state, so `submit<tp::Future>` makes one
+/// allocation per task. `run()` invokes the callable, publishes the outcome, and
+/// drops the task's reference.
+template <typename T, typename Fn>
+class TaskState final : public FutureState<T> {
+public:
+    explicit TaskState(Fn fn) : fn_(std::move(fn)) {}
+
+    void run() noexcept {
+        try {
+            if constexpr (std::is_void_v<T>) {
+                (*fn_)();
+                fn_.reset();
+                this->set_value();
+            } else {
+                T value = (*fn_)();
+                fn_.reset();
+                this->set_value(std::move(value));
+            }
+        } catch (...) {
+            fn_.reset();
+            this->set_exception(std::current_exception());
+        }
+        this->release();
+    }
+
+private:
+    std::optional<Fn> fn_;
+};
+
+}  // namespace detail
+
+/// Lightweight single-consumer future. `get()` spins briefly, then (on a pool
+/// worker) runs other queued tasks, and only then parks, so a result that is
+/// already or almost ready costs no futex wait. Move-only; `get()` may be
+/// called once.
+template <typename T>
+class Future {
+    static_assert(!std::is_reference_v<T>, "tp::Future does not support reference results");
+
+public:
+    Future() noexcept = default;
+
+    Future(Future&& other) noexcept : state_(std::exchange(other.state_, nullptr)) {}
+
+    Future& operator=(Future&& other) noexcept {
+        if (this != &other) {
+            reset();
+            state_ = std::exchange(other.state_, nullptr);
+        }
+        return *this;
+    }
+
+    Future(const Future&) = delete;
+    Future& operator=(const Future&) = delete;
+
+    ~Future() { reset(); }
+
+    /// `false` when default constructed, moved from, or after `get()`.
+    bool valid() const noexcept { return state_ != nullptr; }
+
+    /// Non-blocking readiness check.
+    bool is_ready() const noexcept { return state_ != nullptr && state_->ready(); }
+
+    void wait() const {
+        check_valid();
+        state_->wait();
+    }
+
+    /// Waits for the result and returns it (or rethrows the task's exception).
+    /// Leaves the future invalid.
+    T get() {
+        check_valid();
+        state_->wait();
+        detail::FutureState<T>* state = std::exchange(state_, nullptr);
+        struct Release {
+            detail::FutureState<T>* state;
+            ~Release() { state->release(); }
+        } release{state};
+        return state->take();
+    }
+
+private:
+    friend class Promise<T>;
+    friend class ThreadPool;
+
+    explicit Future(detail::FutureState<T>* state) noexcept : state_(state) {}
+
+    void check_valid() const {
+        if (state_ == nullptr) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+    }
+
+    void reset() noexcept {
+        if (state_ != nullptr) {
+            std::exchange(state_, nullptr)->release();
+        }
+    }
+
+    detail::FutureState<T>* state_ = nullptr;
+};
+
+/// Producer side for a `Future<T>`. Destroying an unsatisfied promise stores a
+/// `std::future_error(broken_promise)` so waiters never hang.
+template <typename T>
+class Promise {
+public:
+    Promise() : state_(new detail::FutureState<T>()) {}
+
+    Promise(Promise&& other) noexcept
+        : state_(std::exchange(other.state_, nullptr)),
+          future_taken_(std::exchange(other.future_taken_, false)) {}
+
+    Promise& operator=(Promise&& other) noexcept {
+        if (this != &other) {
+            abandon();
+            state_ = std::exchange(other.state_, nullptr);
+            future_taken_ = std::exchange(other.future_taken_, false);
+        }
+        return *this;
+    }
+
+    Promise(const Promise&) = delete;
+    Promise& operator=(const Promise&) = delete;
+
+    ~Promise() { abandon(); }
+
+    /// Returns the paired future; may be called once.
+    Future<T> get_future() {
+        if (state_ == nullptr) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+        if (future_taken_) {
+            throw std::future_error(std::future_errc::future_already_retrieved);
+        }
+        future_taken_ = true;
+        return Future<T>(state_);
+    }
+
+    template <typename... V>
+    void set_value(V&&... value) {
+        if (state_ == nullptr) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+        state_->set_value(std::forward<V>(value)...);
+    }
+
+    void set_exception(std::exception_ptr error) {
+        if (state_ == nullptr) {
+            throw std::future_error(std::future_errc::no_state);
+        }
+        state_->set_exception(std::move(error));
+    }
+
+private:
+    void abandon() noexcept {
+        if (state_ == nullptr) return;
+        if (!state_->ready()) {
+            try {
+                state_->set_exception(
+                    std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+            } catch (...) {
+            }
+        }
+        // The future's reference was never handed out, so drop it here too.
+        if (!future_taken_) {
+            state_->release();
+        }
+        std::exchange(state_, nullptr)->release();
+    }
+
+    detail::FutureState<T>* state_ = nullptr;
+    bool future_taken_ = false;
+};
+
+}  // namespace tp
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace tp {
+
+/// Counter snapshot reported by `BasicThreadPool::stats()`. With `policy::NoStats`
+/// the task counters stay zero; `queued` and `workers` are always filled in.
+struct BasicPoolStats {
+    uint64_t submitted = 0;
+    uint64_t completed = 0;
+    uint64_t rejected = 0;
+    uint64_t queued = 0;
+    uint64_t workers = 0;
+};
+
+/// Compile-time building blocks for `BasicThreadPool`. Each policy family has a
+/// full-featured default and a lean alternative whose hooks compile to nothing.
+namespace policy {
+
+// ---------------------------------------------------------------------------
+// Queue policies: `template <typename T> class queue` with non-blocking
+// `try_push(T&&)`, `try_pop()`, `empty()`, and `size()`. Sleeping is left to the
+// idle policy.
+// ---------------------------------------------------------------------------
+
+/// Unbounded FIFO guarded by a mutex (the same structure `BlockingQueue` uses).
+struct MutexQueue {
+    template <typename T>
+    class queue {
+    public:
+        bool try_push(T&& value) {
+            std::lock_guard<std::mutex> lock(mtx_);
+            items_.push_back(std::move(value));
+            return true;
+        }
+
+        std::optional<T> try_pop() {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (items_.empty()) return std::nullopt;
+            T front = std::move(items_.front());
+            items_.pop_front();
+            return front;
+        }
+
+        bool empty() const {
+            std::lock_guard<std::mutex> lock(mtx_);
+            return items_.empty();
+        }
+
+        size_t size() const {
+            std::lock_guard<std::mutex> lock(mtx_);
+            return items_.size();
+        }
+
+    private:
+        mutable std::mutex mtx_;
+        std::deque<T> items_;
+    };
+};
+
+/// Bounded lock-free MPMC ring (Vyukov-style sequence numbers). One allocation at
+/// construction, none per task. `try_push` fails when full; the pool then yields
+/// until a slot frees up.
+template <size_t Capacity = 4096>
+struct RingQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "RingQueue capacity must be a power of two");
+
+    template <typename T>
+    class queue {
+    public:
+        queue() : cells_(std::make_unique<Cell[]>(Capacity)) {
+            for (size_t i = 0; i < Capacity; ++i) {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ~queue() {
+            while (try_pop().has_value()) {
+            }
+        }
+
+        queue(const queue&) = delete;
+        queue& operator=(const queue&) = delete;
+
+        /// Moves from `value` only on success.
+        bool try_push(T&& value) {
+            size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            Cell* cell = nullptr;
+            while (true) {
+                cell = &cells_[pos & kMask];
+                const size_t seq = cell->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0) {
+                    if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+            ::new (static_cast<void*>(cell->storage)) T(std::move(value));
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        std::optional<T> try_pop() {
+            size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+            Cell* cell = nullptr;
+            while (true) {
+                cell = &cells_[pos & kMask];
+                const size_t seq = cell->sequence.load(std::memory_order_acquire);
+                const auto diff =
+                    static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+                if (diff == 0) {
+                    if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return std::nullopt;
+                } else {
+                    pos = dequeue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+            T* item = std::launder(reinterpret_cast<T*>(cell->storage));
+            std::optional<T> out(std::move(*item));
+            item->~T();
+            cell->sequence.store(pos + Capacity, std::memory_order_release);
+            return out;
+        }
+
+        /// Approximate under concurrent use, like any lock-free size query.
+        size_t size() const {
+            const size_t tail = enqueue_pos_.load(std::memory_order_acquire);
+            const size_t head = dequeue_pos_.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+
+        bool empty() const { return size() == 0; }
+
+    private:
+        static constexpr size_t kMask = Capacity - 1;
+
+        struct Cell {
+            std::atomic<size_t> sequence{0};
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        std::unique_ptr<Cell[]> cells_;
+        alignas(64) std::atomic<size_t> enqueue_pos_{0};
+        alignas(64) std::atomic<size_t> dequeue_pos_{0};
+    };
+};
+
+// ---------------------------------------------------------------------------
+// Idle policies: how a worker waits for work. `wait(ready)` returns once
+// `ready()` is true; `notify_one()`/`notify_all()` are called after a push and
+// on shutdown.
+// ---------------------------------------------------------------------------
+
+/// Sleep on a condition variable. Submitters only touch the mutex when a worker
+/// is actually asleep, tracked with a Dekker-style sleeper count. Before sleeping,
+/// a worker yields a few times (like `ThreadPool`'s idle workers) so a burst of
+/// submits lands without a futex wakeup per task.
+class BlockingIdle {
+public:
+    static constexpr int kIdleYields = 4;
+
+    template <typename Ready>
+    void wait(Ready&& ready) {
+        for (int i = 0; i < kIdleYields; ++i) {
+            std::this_thread::yield();
+            if (ready()) return;
+        }
+        std::unique_lock<std::mutex> lock(mtx_);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        cv_.wait(lock, ready);
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notify_one() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_seq_cst) == 0) return;
+        { std::lock_guard<std::mutex> lock(mtx_); }
+        cv_.notify_one();
+    }
+
+    void notify_all() {
+        { std::lock_guard<std::mutex> lock(mtx_); }
+        cv_.notify_all();
+    }
+
+private:
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::atomic<uint32_t> sleepers_{0};
+};
+
+/// Poll with `std::this_thread::yield()` instead of sleeping: submit never
+/// notifies, at the price of burning CPU while idle. Best with one worker per core.
+class SpinIdle {
+public:
+    template <typename Ready>
+    void wait(Ready&& ready) {
+        while (!ready()) {
+            std::this_thread::yield();
+        }
+    }
+
+    void notify_one() noexcept {}
+    void notify_all() noexcept {}
+};
+
+// ---------------------------------------------------------------------------
+// Stats policies: per-task hooks plus `fill(BasicPoolStats&)`.
+// ---------------------------------------------------------------------------
+
+/// Relaxed atomic counters, matching `ThreadPool::Stats`.
+class AtomicStats {
+public:
+    void on_submit() noexcept { submitted_.fetch_add(1, std::memory_order_relaxed); }
+    void on_complete() noexcept { completed_.fetch_add(1, std::memory_order_relaxed); }
+    void on_reject() noexcept { rejected_.fetch_add(1, std::memory_order_relaxed); }
+
+    void fill(BasicPoolStats& snapshot) const noexcept {
+        snapshot.submitted = submitted_.load(std::memory_order_relaxed);
+        snapshot.completed = completed_.load(std::memory_order_relaxed);
+        snapshot.rejected = rejected_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<uint64_t> rejected_{0};
+};
+
+/// No counters at all; every hook is an empty inline function.
+struct NoStats {
+    void on_submit() noexcept {}
+    void on_complete() noexcept {}
+    void on_reject() noexcept {}
+    void fill(BasicPoolStats&) const noexcept {}
+};
+
+// ---------------------------------------------------------------------------
+// Task policies: `Task` is a move-constructible `void()` callable and
+// `make(F&&)` wraps any callable into it.
+// ---------------------------------------------------------------------------
+
+/// Type-erase through `std::function`. Move-only callables (such as a
+/// `std::packaged_task`) are kept behind a `shared_ptr` to satisfy copyability.
+struct FunctionTask {
+    using Task = std::function<void()>;
+
+    template <typename F>
+    static Task make(F&& fn) {
+        using Fn = std::decay_t<F>;
+        if constexpr (std::is_copy_constructible_v<Fn>) {
+            return Task(std::forward<F>(fn));
+        } else {
+            auto shared = std::make_shared<Fn>(std::forward<F>(fn));
+            return Task([shared]() { (*shared)(); });
+        }
+    }
+};
+
+/// Move-only callable stored inline in `Capacity` bytes: no heap allocation per
+/// task. Callables that do not fit are rejected at compile time.
+template <size_t Capacity = 64>
+struct InplaceTask {
+    class Task {
+    public:
+        Task() noexcept = default;
+
+        template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+        explicit Task(F&& fn) {
+            using Fn = std::decay_t<F>;
+            static_assert(sizeof(Fn) <= Capacity, "callable too large for InplaceTask; raise Capacity");
+            static_assert(alignof(Fn) <= alignof(std::max_align_t), "callable over-aligned for InplaceTask");
+            static_assert(std::is_nothrow_move_constructible_v<Fn>,
+                          "InplaceTask requires a nothrow-movable callable");
+            ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(fn));
+            ops_ = &kOps<Fn>;
+        }
+
+        Task(Task&& other) noexcept : ops_(other.ops_) {
+            if (ops_ != nullptr) {
+                ops_->relocate(storage_, other.storage_);
+                other.ops_ = nullptr;
+            }
+        }
+
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                reset();
+                ops_ = other.ops_;
+                if (ops_ != nullptr) {
+                    ops_->relocate(storage_, other.storage_);
+                    other.ops_ = nullptr;
+                }
+            }
+            return *this;
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        ~Task() { reset(); }
+
+        void operator()() { ops_->invoke(storage_); }
+
+        explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    private:
+        struct Ops {
+            void (*invoke)(void*);
+            void (*relocate)(void* dst, void* src) noexcept;  // move into dst, destroy src
+            void (*destroy)(void*) noexcept;
+        };
+
+        template <typename Fn>
+        static constexpr Ops kOps{
+            [](void* self) { (*static_cast<Fn*>(self))(); },
+            [](void* dst, void* src) noexcept {
+                ::new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+                static_cast<Fn*>(src)->~Fn();
+            },
+            [](void* self) noexcept { static_cast<Fn*>(self)->~Fn(); },
+        };
+
+        void reset() noexcept {
+            if (ops_ != nullptr) {
+                ops_->destroy(storage_);
+                ops_ = nullptr;
+            }
+        }
+
+        alignas(std::max_align_t) unsigned char storage_[Capacity];
+        const Ops* ops_ = nullptr;
+    };
+
+    template <typename F>
+    static Task make(F&& fn) {
+        return Task(std::forward<F>(fn));
+    }
+};
+
+}  // namespace policy
+}  // namespace tp
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <thread>
 #include <type_traits>
@@ -12,13 +14,17 @@
 #include <vector>
 
 #include "tp/blocking_queue.hpp"
+#include "tp/future.hpp"
 #include "tp/stop_token.hpp"
 
 namespace tp {
 
+class BlockingScope;
+
 /// Minimal public surface for the thread pool used in this project.
-/// The implementation will drive a set of worker threads that pop tasks
-/// from a shared `BlockingQueue` and honor the `StopToken`/`StopSource`.
+/// The implementation drives a set of worker threads that pop tasks from a
+/// shared `BlockingQueue` plus one local queue per worker (for affine tasks),
+/// and honor the `StopToken`/`StopSource`.
 class ThreadPool {
 public:
     struct Stats {
@@ -27,9 +33,24 @@ public:
         uint64_t rejected = 0;
         uint64_t queued = 0;
         uint64_t workers = 0;
+        /// Affine tasks run by their preferred worker vs. stolen by another one.
+        uint64_t affine_hits = 0;
+        uint64_t affine_steals = 0;
+        /// `affine_hits / (affine_hits + affine_steals)`, or 0 when no affine task ran.
+        double locality_hit_rate = 0.0;
+        /// Workers currently inside a `BlockingScope`, and the compensating
+        /// workers running in their place.
+        uint64_t blocked = 0;
+        uint64_t compensating = 0;
     };
 
-    explicit ThreadPool(size_t worker_count = std::thread::hardware_concurrency());
+    /// Pass as `max_compensating` to allow as many compensating workers as regular ones.
+    static constexpr size_t kSameAsWorkers = static_cast<size_t>(-1);
+
+    /// `max_compensating` caps the extra workers started while tasks are inside a
+    /// `BlockingScope`; 0 disables compensation.
+    explicit ThreadPool(size_t worker_count = std::thread::hardware_concurrency(),
+                        size_t max_compensating = kSameAsWorkers);
 
     ThreadPool(const ThreadPool&) = delete;
     ThreadPool& operator=(const ThreadPool&) = delete;
@@ -38,9 +59,24 @@ public:
 
     /// Schedule a callable with arguments. Returns a future when accepted,
     /// or `std::nullopt` if the pool is closed/shutting down.
-    template <typename Callable, typename... Args>
+    /// `submit<tp::Future>(...)` returns the pool-native `tp::Future` instead of
+    /// `std::future`: one allocation per task and a spin-then-wait `get()`.
+    template <template <typename> class FutureT = std::future, typename Callable, typename... Args>
     auto submit(Callable&& callable, Args&&... args)
-        -> std::optional<std::future<std::invoke_result_t<Callable, Args...>>>;
+        -> std::optional<FutureT<std::invoke_result_t<Callable, Args...>>>;
+
+    /// Like `submit()`, but hashes `key` to a preferred worker and enqueues the task
+    /// on that worker's local queue, so tasks sharing a key tend to run on the same
+    /// core. Other workers only steal it once their own local queue is empty.
+    template <template <typename> class FutureT = std::future, typename Key, typename Callable,
+              typename... Args>
+    auto submit_affine(const Key& key, Callable&& callable, Args&&... args)
+        -> std::optional<FutureT<std::invoke_result_t<Callable, Args...>>>;
+
+    /// Run `callable(args...)` inside a `BlockingScope`, so a worker that blocks in it
+    /// is temporarily replaced. Returns whatever the callable returns.
+    template <typename Callable, typename... Args>
+    decltype(auto) run_blocking(Callable&& callable, Args&&... args);
 
     /// Initiate an orderly shutdown: stop accepting new tasks, wake all workers,
     /// and join them before returning.
@@ -52,26 +88,115 @@ public:
     /// Share a stop token with tasks/helpers so they can react to shutdown.
     StopToken get_stop_token() const noexcept;
 
+    /// Number of regular workers (compensating ones excluded). Unlike `stats()`,
+    /// takes no locks.
+    size_t worker_count() const noexcept;
+
     /// Snapshot basic telemetry counters.
     Stats stats() const noexcept;
 
     ~ThreadPool();
 
 private:
-    struct Impl {
-        explicit Impl(size_t worker_count);
+    friend class BlockingScope;
+    friend bool detail::help_current_pool();
+
+    using Task = std::function<void()>;
+
+    /// Marks a task that may run on any worker (no affinity).
+    static constexpr size_t kAnyWorker = static_cast<size_t>(-1);
+
+    struct Worker {
+        BlockingQueue<Task> local;
+        std::condition_variable wake;
+        bool idle = false;    // guarded by Impl::idle_mtx
+        bool parked = false;  // compensating worker not currently needed; guarded by Impl::idle_mtx
+        size_t scopes = 0;    // BlockingScopes open on this worker; guarded by Impl::idle_mtx
+        std::thread thread;
+    };
 
-        BlockingQueue<std::function<void()>> queue;
+    struct Impl {
+        Impl(size_t worker_count, size_t max_compensating);
+
+        /// Enqueue on the shared queue (`preferred == kAnyWorker`) or on the
+        /// preferred worker's local queue, then wake a sleeping worker.
+        bool push(Task task, size_t preferred);
+        void run_worker(size_t index);
+        /// Pops the worker's next task; `steal` also lets it take affine work
+        /// queued for a peer.
+        std::optional<Task> next_task(size_t index, bool steal = true);
+        void close();
+        void enter_blocking();
+        void exit_blocking();
+        /// Parks a compensating worker once fewer workers are blocked than
+        /// compensating ones run; returns `false` when it should exit instead.
+        bool park_if_surplus(Worker& self);
+        /// Wakes one sleeping worker, if any. Requires `idle_mtx`.
+        void wake_one();
+
+        /// Yields an idle worker makes, re-checking its own and the shared queue,
+        /// before it steals or sleeps. Lets a burst of submits land without a
+        /// wakeup each, and gives a busy owner the first chance at its affine work.
+        static constexpr int kIdleYields = 4;
+
+        /// The pool (if any) whose worker is running on this thread, and its slot.
+        static thread_local Impl* current;
+        static thread_local size_t current_index;
+
+        BlockingQueue<Task> queue;
         StopSource stop_source;
         std::atomic<bool> shutdown{false};
         std::atomic<uint64_t> submitted{0};
         std::atomic<uint64_t> completed{0};
         std::atomic<uint64_t> rejected{0};
-        std::vector<std::thread> workers;
+        std::atomic<uint64_t> affine_hits{0};
+        std::atomic<uint64_t> affine_steals{0};
+        /// Tasks pushed but not yet popped; incremented before the push so
+        /// workers never exit while a task is still landing in a queue.
+        std::atomic<uint64_t> pending{0};
+        /// Affine tasks sitting in local queues; while zero, workers skip the
+        /// local queues and the steal scan.
+        std::atomic<uint64_t> affine_queued{0};
+        /// Workers with `idle` set; lets `push()` skip `idle_mtx` when nobody sleeps.
+        std::atomic<size_t> sleepers{0};
+        /// Workers in their idle yield/steal phase. A non-affine push skips the
+        /// wakeup while one searches; a searcher that finds work with more still
+        /// pending (or parks) wakes a sleeper in its place.
+        std::atomic<size_t> searching{0};
+        std::mutex idle_mtx;
+        bool stopping = false;     // guarded by idle_mtx
+        size_t blocked = 0;        // guarded by idle_mtx
+        size_t compensating = 0;   // guarded by idle_mtx
+        size_t spawned = 0;        // compensating slots started so far; guarded by idle_mtx
+        /// The first `core_count` slots are regular workers; the rest are
+        /// compensating slots, created and started lazily, that park when idle.
+        size_t core_count = 0;
+        std::vector<std::unique_ptr<Worker>> workers;
     };
+
+    template <template <typename> class FutureT, typename Callable, typename... Args>
+    auto enqueue(size_t preferred, Callable&& callable, Args&&... args)
+        -> std::optional<FutureT<std::invoke_result_t<Callable, Args...>>>;
+
     std::unique_ptr<Impl> impl_;
 };
 
+/// RAII marker for code about to block (file reads, `get()` on external work).
+/// On a pool worker it lets the pool start a compensating worker, up to the
+/// pool's cap, and retires that worker when the scope ends. On any other
+/// thread it does nothing.
+class BlockingScope {
+public:
+    BlockingScope();
+    ~BlockingScope();
+
+    BlockingScope(const BlockingScope&) = delete;
+    BlockingScope& operator=(const BlockingScope&) = delete;
+
+private:
+    ThreadPool::Impl* impl_ = nullptr;
+};
+
 }  // namespace tp
 
 #include "tp/thread_pool_impl.hpp"
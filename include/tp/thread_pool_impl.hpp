@@ -4,10 +4,35 @@
 
 namespace tp {
 
-template <typename Callable, typename... Args>
+template <template <typename> class FutureT, typename Callable, typename... Args>
 auto ThreadPool::submit(Callable&& callable, Args&&... args)
-    -> std::optional<std::future<std::invoke_result_t<Callable, Args...>>> {
+    -> std::optional<FutureT<std::invoke_result_t<Callable, Args...>>> {
+    return enqueue<FutureT>(kAnyWorker, std::forward<Callable>(callable), std::forward<Args>(args)...);
+}
+
+template <template <typename> class FutureT, typename Key, typename Callable, typename... Args>
+auto ThreadPool::submit_affine(const Key& key, Callable&& callable, Args&&... args)
+    -> std::optional<FutureT<std::invoke_result_t<Callable, Args...>>> {
+    size_t preferred = 0;
+    if (impl_ && impl_->core_count > 0) {
+        preferred = std::hash<Key>{}(key) % impl_->core_count;
+    }
+    return enqueue<FutureT>(preferred, std::forward<Callable>(callable), std::forward<Args>(args)...);
+}
+
+template <typename Callable, typename... Args>
+decltype(auto) ThreadPool::run_blocking(Callable&& callable, Args&&... args) {
+    BlockingScope scope;
+    return std::invoke(std::forward<Callable>(callable), std::forward<Args>(args)...);
+}
+
+template <template <typename> class FutureT, typename Callable, typename... Args>
+auto ThreadPool::enqueue(size_t preferred, Callable&& callable, Args&&... args)
+    -> std::optional<FutureT<std::invoke_result_t<Callable, Args...>>> {
     using Result = std::invoke_result_t<Callable, Args...>;
+    constexpr bool native_future = std::is_same_v<FutureT<Result>, Future<Result>>;
+    static_assert(native_future || std::is_same_v<FutureT<Result>, std::future<Result>>,
+                  "submit returns either std::future or tp::Future");
 
     if (!impl_ || impl_->shutdown.load(std::memory_order_acquire)) {
         if (impl_) {
@@ -16,22 +41,53 @@ auto ThreadPool::submit(Callable&& callable, Args&&... args)
         return std::nullopt;
     }
 
-    auto task_ptr = std::make_shared<std::packaged_task<Result()>>(
-        std::bind(std::forward<Callable>(callable), std::forward<Args>(args)...));
-    auto future = task_ptr->get_future();
-
-    impl_->submitted.fetch_add(1, std::memory_order_relaxed);
-    auto accepted = impl_->queue.push([task_ptr, impl = impl_.get()]() {
-        (*task_ptr)();
-        impl->completed.fetch_add(1, std::memory_order_relaxed);
-    });
-    if (!accepted) {
-        impl_->submitted.fetch_sub(1, std::memory_order_relaxed);
-        impl_->rejected.fetch_add(1, std::memory_order_relaxed);
-        return std::nullopt;
-    }
+    if constexpr (native_future) {
+        // The task and its result share one allocation; the queued closure is
+        // two pointers, small enough for std::function's inline buffer.
+        using Bound = std::decay_t<decltype(std::bind(std::forward<Callable>(callable),
+                                                      std::forward<Args>(args)...))>;
+        auto* state = new detail::TaskState<Result, Bound>(
+            std::bind(std::forward<Callable>(callable), std::forward<Args>(args)...));
+        Future<Result> future(state);
+        // Holds the task's reference until the queue takes it, so a rejected or
+        // throwing push does not leak the state.
+        struct Producer {
+            detail::FutureState<Result>* state;
+            ~Producer() {
+                if (state != nullptr) state->release();
+            }
+        } producer{state};
+
+        impl_->submitted.fetch_add(1, std::memory_order_relaxed);
+        auto accepted = impl_->push([state, impl = impl_.get()]() {
+            state->run();
+            impl->completed.fetch_add(1, std::memory_order_relaxed);
+        }, preferred);
+        if (!accepted) {
+            impl_->submitted.fetch_sub(1, std::memory_order_relaxed);
+            impl_->rejected.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        producer.state = nullptr;
+        return future;
+    } else {
+        auto task_ptr = std::make_shared<std::packaged_task<Result()>>(
+            std::bind(std::forward<Callable>(callable), std::forward<Args>(args)...));
+        auto future = task_ptr->get_future();
 
-    return future;
+        impl_->submitted.fetch_add(1, std::memory_order_relaxed);
+        auto accepted = impl_->push([task_ptr, impl = impl_.get()]() {
+            (*task_ptr)();
+            impl->completed.fetch_add(1, std::memory_order_relaxed);
+        }, preferred);
+        if (!accepted) {
+            impl_->submitted.fetch_sub(1, std::memory_order_relaxed);
+            impl_->rejected.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        return future;
+    }
 }
 
 }  // namespace tp
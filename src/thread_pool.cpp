@@ -4,27 +4,308 @@
 
 namespace tp {
 
-ThreadPool::Impl::Impl(size_t worker_count) {
+thread_local ThreadPool::Impl* ThreadPool::Impl::current = nullptr;
+thread_local size_t ThreadPool::Impl::current_index = 0;
+
+namespace detail {
+
+bool help_current_pool() {
+    auto* impl = ThreadPool::Impl::current;
+    if (impl == nullptr) {
+        return false;
+    }
+    auto task = impl->next_task(ThreadPool::Impl::current_index);
+    if (!task.has_value()) {
+        return false;
+    }
+    (*task)();
+    return true;
+}
+
+}  // namespace detail
+
+ThreadPool::Impl::Impl(size_t worker_count, size_t max_compensating) {
     if (worker_count == 0) {
         worker_count = 1;
     }
+    if (max_compensating == kSameAsWorkers) {
+        max_compensating = worker_count;
+    }
+    core_count = worker_count;
 
-    workers.reserve(worker_count);
+    // Every regular worker slot must exist before any thread starts, since idle
+    // workers scan their peers' local queues when stealing. Compensating slots
+    // stay empty until a `BlockingScope` first needs one (see `spawned`).
+    workers.resize(worker_count + max_compensating);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers[i] = std::make_unique<Worker>();
+    }
     for (size_t i = 0; i < worker_count; ++i) {
-        workers.emplace_back([this]() {
-            while (true) {
-                auto task = queue.pop();
-                if (!task.has_value()) {
-                    break;
+        workers[i]->thread = std::thread([this, i]() { run_worker(i); });
+    }
+}
+
+void ThreadPool::Impl::run_worker(size_t index) {
+    current = this;
+    current_index = index;
+    auto& self = *workers[index];
+    const bool compensating_slot = index >= core_count;
+    while (true) {
+        if (compensating_slot && !park_if_surplus(self)) {
+            break;
+        }
+
+        auto task = next_task(index, false);
+        if (!task.has_value()) {
+            // Give submitters a moment before sleeping (otherwise every push of a
+            // burst pays for a wakeup and the woken worker runs a single task), and
+            // give busy owners a moment to reach their affine work before stealing
+            // it. While we search, `push()` leaves sleepers alone.
+            searching.fetch_add(1, std::memory_order_seq_cst);
+            for (int i = 0; i < kIdleYields && !task.has_value(); ++i) {
+                std::this_thread::yield();
+                if (pending.load(std::memory_order_acquire) > 0) {
+                    task = next_task(index, false);
                 }
-                (*task)();
             }
-        });
+            if (!task.has_value()) {
+                task = next_task(index);
+            }
+            searching.fetch_sub(1, std::memory_order_seq_cst);
+            // Pushes that skipped a wakeup on our account may have queued more
+            // than we took; hand the rest to a sleeper.
+            if (task.has_value() && pending.load(std::memory_order_seq_cst) > 0 &&
+                sleepers.load(std::memory_order_seq_cst) > 0) {
+                std::lock_guard<std::mutex> lock(idle_mtx);
+                wake_one();
+            }
+        }
+        if (task.has_value()) {
+            (*task)();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(idle_mtx);
+        if (pending.load(std::memory_order_seq_cst) > 0) {
+            continue;
+        }
+        if (stopping) {
+            break;
+        }
+        if (compensating_slot && compensating > blocked) {
+            continue;
+        }
+        // Announce ourselves as a sleeper, then re-check `pending`: a submitter
+        // either sees the sleeper count and takes the slow path, or we see its
+        // task here. Both sides use seq_cst so one of the two must happen.
+        self.idle = true;
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        if (pending.load(std::memory_order_seq_cst) == 0) {
+            // A single wait, not a predicate loop: whoever notifies us clears
+            // `idle`, so after any wakeup we must go around and re-mark
+            // ourselves idle before sleeping again, or nobody could wake us.
+            self.wake.wait(lock);
+        }
+        if (self.idle) {
+            self.idle = false;
+            sleepers.fetch_sub(1, std::memory_order_seq_cst);
+        }
+    }
+}
+
+std::optional<ThreadPool::Task> ThreadPool::Impl::next_task(size_t index, bool steal) {
+    // Own local queue first, then the shared queue, and only then steal
+    // affine work that belongs to another worker. Only regular workers
+    // receive affine work, so compensating slots are never stolen from, and
+    // the local queues are skipped entirely while no affine task is queued.
+    const bool has_affine = affine_queued.load(std::memory_order_acquire) > 0;
+    std::optional<Task> task;
+    bool from_local = false;
+    if (has_affine && index < core_count) {
+        task = workers[index]->local.try_pop();
+        if (task.has_value()) {
+            from_local = true;
+            affine_hits.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (!task.has_value()) {
+        task = queue.try_pop();
+    }
+    for (size_t offset = 1; steal && has_affine && !task.has_value() && offset <= core_count;
+         ++offset) {
+        const size_t victim = (index + offset) % core_count;
+        if (victim == index) {
+            continue;
+        }
+        task = workers[victim]->local.try_pop();
+        if (task.has_value()) {
+            from_local = true;
+            affine_steals.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (from_local) {
+        affine_queued.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    if (task.has_value()) {
+        pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    return task;
+}
+
+bool ThreadPool::Impl::push(Task task, size_t preferred) {
+    const bool affine = preferred != kAnyWorker;
+    pending.fetch_add(1, std::memory_order_seq_cst);
+    if (affine) {
+        affine_queued.fetch_add(1, std::memory_order_acq_rel);
+    }
+    // Undo the counts if the task never lands (closed queue, or a throwing
+    // allocation); a stale `pending` would keep idle workers from sleeping.
+    auto rollback = [this, affine]() {
+        if (affine) {
+            affine_queued.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        pending.fetch_sub(1, std::memory_order_acq_rel);
+    };
+    auto& target = affine ? workers[preferred]->local : queue;
+    bool pushed = false;
+    try {
+        pushed = target.push(std::move(task));
+    } catch (...) {
+        rollback();
+        throw;
+    }
+    if (!pushed) {
+        rollback();
+        return false;
+    }
+
+    // Fast path: every worker is busy and will find the task before sleeping,
+    // or one is searching and will find it (or pass it on) before sleeping.
+    if (sleepers.load(std::memory_order_seq_cst) == 0) {
+        return true;
+    }
+    if (!affine && searching.load(std::memory_order_seq_cst) > 0) {
+        return true;
+    }
+
+    // An affine task only wakes its owner: a peer woken for it would steal it
+    // straight away, a guaranteed locality miss. A busy owner (or a peer that
+    // runs out of work) picks it up later, unless the owner is inside a
+    // `BlockingScope` and may not come back soon. Other tasks wake any sleeper.
+    std::lock_guard<std::mutex> lock(idle_mtx);
+    Worker* sleeper = nullptr;
+    if (affine) {
+        auto& owner = *workers[preferred];
+        if (owner.idle) {
+            sleeper = &owner;
+        } else if (owner.scopes == 0) {
+            return true;
+        }
+    }
+    if (sleeper != nullptr) {
+        sleeper->idle = false;
+        sleepers.fetch_sub(1, std::memory_order_seq_cst);
+        sleeper->wake.notify_one();
+    } else {
+        wake_one();
+    }
+    return true;
+}
+
+void ThreadPool::Impl::wake_one() {
+    // Only slots that have actually been started are scanned.
+    for (size_t i = 0; i < core_count + spawned; ++i) {
+        auto& worker = *workers[i];
+        if (worker.idle) {
+            worker.idle = false;
+            sleepers.fetch_sub(1, std::memory_order_seq_cst);
+            worker.wake.notify_one();
+            return;
+        }
+    }
+}
+
+void ThreadPool::Impl::close() {
+    queue.close();
+    for (size_t i = 0; i < core_count; ++i) {
+        workers[i]->local.close();
+    }
+
+    std::lock_guard<std::mutex> lock(idle_mtx);
+    stopping = true;
+    for (size_t i = 0; i < core_count + spawned; ++i) {
+        workers[i]->wake.notify_all();
+    }
+}
+
+void ThreadPool::Impl::enter_blocking() {
+    std::lock_guard<std::mutex> lock(idle_mtx);
+    ++blocked;
+    ++workers[current_index]->scopes;
+    if (stopping || compensating >= workers.size() - core_count) {
+        return;
+    }
+
+    // Reuse a parked compensating worker if there is one; otherwise start the
+    // next never-used slot.
+    ++compensating;
+    for (size_t i = core_count; i < core_count + spawned; ++i) {
+        auto& slot = *workers[i];
+        if (slot.parked) {
+            slot.parked = false;
+            slot.wake.notify_one();
+            return;
+        }
+    }
+
+    // Starting a thread can fail (e.g. EAGAIN). Blocking without compensation
+    // is still correct, so roll back and carry on rather than throwing into
+    // the caller's task.
+    const size_t index = core_count + spawned;
+    try {
+        if (!workers[index]) {
+            workers[index] = std::make_unique<Worker>();
+        }
+        workers[index]->thread = std::thread([this, index]() { run_worker(index); });
+        ++spawned;
+    } catch (...) {
+        --compensating;
+    }
+}
+
+void ThreadPool::Impl::exit_blocking() {
+    // The surplus compensating worker notices at its next task boundary;
+    // wake sleeping ones so they can park right away.
+    std::lock_guard<std::mutex> lock(idle_mtx);
+    --blocked;
+    --workers[current_index]->scopes;
+    if (compensating > blocked) {
+        for (size_t i = core_count; i < core_count + spawned; ++i) {
+            if (workers[i]->idle) {
+                workers[i]->wake.notify_one();
+            }
+        }
+    }
+}
+
+bool ThreadPool::Impl::park_if_surplus(Worker& self) {
+    std::unique_lock<std::mutex> lock(idle_mtx);
+    if (compensating <= blocked) {
+        return true;
+    }
+    --compensating;
+    // We may have been searching when a push skipped its wakeup; pass it on.
+    if (pending.load(std::memory_order_seq_cst) > 0) {
+        wake_one();
     }
+    self.parked = true;
+    self.wake.wait(lock, [this, &self] { return stopping || !self.parked; });
+    return !stopping;
 }
 
-ThreadPool::ThreadPool(size_t worker_count)
-    : impl_(std::make_unique<Impl>(worker_count)) {}
+ThreadPool::ThreadPool(size_t worker_count, size_t max_compensating)
+    : impl_(std::make_unique<Impl>(worker_count, max_compensating)) {}
 
 ThreadPool::~ThreadPool() {
     shutdown();
@@ -38,18 +319,18 @@ void ThreadPool::shutdown() {
     }
 
     impl_->stop_source.request_stop();
-    impl_->queue.close();
+    impl_->close();
 
     const auto current_id = std::this_thread::get_id();
     for (auto& worker : impl_->workers) {
-        if (!worker.joinable()) {
+        if (!worker || !worker->thread.joinable()) {
             continue;
         }
-        if (worker.get_id() == current_id) {
-            worker.detach();
+        if (worker->thread.get_id() == current_id) {
+            worker->thread.detach();
             continue;
         }
-        worker.join();
+        worker->thread.join();
     }
 }
 
@@ -64,6 +345,10 @@ StopToken ThreadPool::get_stop_token() const noexcept {
     return impl_->stop_source.get_token();
 }
 
+size_t ThreadPool::worker_count() const noexcept {
+    return impl_ ? impl_->core_count : 0;
+}
+
 ThreadPool::Stats ThreadPool::stats() const noexcept {
     Stats snapshot;
     if (!impl_) {
@@ -73,8 +358,35 @@ ThreadPool::Stats ThreadPool::stats() const noexcept {
     snapshot.completed = impl_->completed.load(std::memory_order_relaxed);
     snapshot.rejected = impl_->rejected.load(std::memory_order_relaxed);
     snapshot.queued = impl_->queue.size();
-    snapshot.workers = impl_->workers.size();
+    for (size_t i = 0; i < impl_->core_count; ++i) {
+        snapshot.queued += impl_->workers[i]->local.size();
+    }
+    snapshot.workers = impl_->core_count;
+    snapshot.affine_hits = impl_->affine_hits.load(std::memory_order_relaxed);
+    snapshot.affine_steals = impl_->affine_steals.load(std::memory_order_relaxed);
+    const auto affine_total = snapshot.affine_hits + snapshot.affine_steals;
+    if (affine_total > 0) {
+        snapshot.locality_hit_rate =
+            static_cast<double>(snapshot.affine_hits) / static_cast<double>(affine_total);
+    }
+    {
+        std::lock_guard<std::mutex> lock(impl_->idle_mtx);
+        snapshot.blocked = impl_->blocked;
+        snapshot.compensating = impl_->compensating;
+    }
     return snapshot;
 }
 
+BlockingScope::BlockingScope() : impl_(ThreadPool::Impl::current) {
+    if (impl_ != nullptr) {
+        impl_->enter_blocking();
+    }
+}
+
+BlockingScope::~BlockingScope() {
+    if (impl_ != nullptr) {
+        impl_->exit_blocking();
+    }
+}
+
 }
@@ -0,0 +1,77 @@
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tp/thread_pool.hpp"
+
+/// Validates submit_affine results, hit accounting, and locality stats.
+int main() {
+    tp::ThreadPool pool(4);
+
+    auto fut_opt = pool.submit_affine(std::string("shard-7"), [](int a, int b) { return a * b; }, 6, 7);
+    assert(fut_opt.has_value());
+    auto value = fut_opt->get();
+    assert(value == 42);
+
+    // With a single worker there is nobody to steal from, so every affine task is a hit.
+    {
+        tp::ThreadPool solo(1);
+        for (int i = 0; i < 16; ++i) {
+            auto fut = solo.submit_affine(i, [] {});
+            assert(fut.has_value());
+            fut->get();
+        }
+        auto solo_stats = solo.stats();
+        assert(solo_stats.affine_hits == 16);
+        assert(solo_stats.affine_steals == 0);
+        assert(solo_stats.locality_hit_rate == 1.0);
+    }
+
+    // Affine submits wake only the owner, but an owner blocked inside a
+    // BlockingScope must not strand its own work: a peer steals it. No
+    // compensating workers, so the peer is the only way forward.
+    {
+        tp::ThreadPool pair(2, 0);
+        auto outer = pair.submit([&pair]() {
+            return pair.run_blocking([&pair]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));  // let the peer fall asleep
+                int sum = 0;
+                for (int key = 0; key < 2; ++key) {
+                    auto inner = pair.submit_affine(key, [key] { return key + 1; });
+                    sum += inner->get();
+                }
+                return sum;
+            });
+        });
+        assert(outer.has_value());
+        const int sum = outer->get();
+        assert(sum == 3);
+    }
+
+    std::atomic<int> counter{0};
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 1000; ++i) {
+        auto fut = pool.submit_affine(i % 8, [&counter]() {
+            counter.fetch_add(1, std::memory_order_relaxed);
+        });
+        assert(fut.has_value());
+        futures.push_back(std::move(*fut));
+    }
+    for (auto& fut : futures) {
+        fut.get();
+    }
+    assert(counter.load(std::memory_order_relaxed) == 1000);
+
+    auto stats = pool.stats();
+    assert(stats.affine_hits + stats.affine_steals == 1001);
+    assert(stats.locality_hit_rate > 0.0 && stats.locality_hit_rate <= 1.0);
+
+    pool.shutdown();
+    auto after_shutdown = pool.submit_affine(1, [] {});
+    assert(!after_shutdown.has_value());
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "tp/algorithms.hpp"
+#include "tp/thread_pool.hpp"
+
+/// Validates parallel algorithms against their std counterparts across sizes.
+int main() {
+    tp::ThreadPool pool(4);
+    std::mt19937_64 rng(42);
+
+    for (size_t size : {size_t{0}, size_t{1}, size_t{7}, size_t{4096}, size_t{100'003}, size_t{1'000'000}}) {
+        std::vector<int64_t> data(size);
+        for (auto& v : data) v = static_cast<int64_t>(rng() % 1000) - 500;
+
+        std::vector<int64_t> sorted = data;
+        tp::parallel_sort(pool, sorted.begin(), sorted.end());
+        std::vector<int64_t> expected_sorted = data;
+        std::sort(expected_sorted.begin(), expected_sorted.end());
+        assert(sorted == expected_sorted);
+
+        std::vector<int64_t> desc = data;
+        tp::parallel_sort(pool, desc.begin(), desc.end(), std::greater<>{});
+        assert(std::is_sorted(desc.begin(), desc.end(), std::greater<>{}));
+
+        std::vector<int64_t> inclusive(size);
+        std::vector<int64_t> expected_inclusive(size);
+        tp::parallel_inclusive_scan(pool, data.begin(), data.end(), inclusive.begin());
+        std::inclusive_scan(data.begin(), data.end(), expected_inclusive.begin());
+        assert(inclusive == expected_inclusive);
+
+        std::vector<int64_t> exclusive = data;
+        std::vector<int64_t> expected_exclusive(size);
+        tp::parallel_exclusive_scan(pool, exclusive.begin(), exclusive.end(), exclusive.begin(), int64_t{10});
+        std::exclusive_scan(data.begin(), data.end(), expected_exclusive.begin(), int64_t{10});
+        assert(exclusive == expected_exclusive);
+
+        std::vector<int64_t> squared(size);
+        tp::parallel_transform(pool, data.begin(), data.end(), squared.begin(), [](int64_t v) { return v * v; });
+        std::vector<int64_t> expected_squared(size);
+        std::transform(data.begin(), data.end(), expected_squared.begin(), [](int64_t v) { return v * v; });
+        assert(squared == expected_squared);
+
+        auto sum_sq = tp::parallel_transform_reduce(pool, data.begin(), data.end(), int64_t{3},
+                                                    std::plus<>{}, [](int64_t v) { return v * v; });
+        auto expected_sum_sq = std::transform_reduce(data.begin(), data.end(), int64_t{3}, std::plus<>{},
+                                                     [](int64_t v) { return v * v; });
+        assert(sum_sq == expected_sum_sq);
+
+        auto sum = tp::parallel_reduce(pool, data.begin(), data.end(), int64_t{0});
+        auto expected_sum = std::reduce(data.begin(), data.end(), int64_t{0});
+        assert(sum == expected_sum);
+    }
+
+    // Non-trivial value types go through the same merge path.
+    std::vector<std::string> words(20'000);
+    for (auto& w : words) w = std::to_string(rng() % 100'000);
+    tp::parallel_sort(pool, words.begin(), words.end());
+    assert(std::is_sorted(words.begin(), words.end()));
+
+    // Exceptions from a chunk surface on the caller.
+    std::vector<int> values(100'000, 1);
+    bool threw = false;
+    try {
+        tp::parallel_transform(pool, values.begin(), values.end(), values.begin(), [](int v) -> int {
+            if (v == 1) throw std::runtime_error("boom");
+            return v;
+        });
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // After shutdown every chunk runs inline on the caller.
+    pool.shutdown();
+    std::vector<int> late(50'000);
+    std::iota(late.rbegin(), late.rend(), 0);
+    tp::parallel_sort(pool, late.begin(), late.end());
+    assert(std::is_sorted(late.begin(), late.end()));
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <atomic>
+#include <cassert>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "tp/basic_thread_pool.hpp"
+
+namespace {
+
+/// Submit/post/drain/reject checks shared by every policy combination.
+template <typename Pool>
+void exercise(bool counts_tasks) {
+    Pool pool(3);
+
+    auto fut_opt = pool.submit([](int a, int b) { return a + b; }, 3, 4);
+    assert(fut_opt.has_value());
+    const int sum = fut_opt->get();
+    assert(sum == 7);
+
+    auto throwing = pool.submit([]() -> int { throw 5; });
+    assert(throwing.has_value());
+    bool threw = false;
+    try {
+        throwing->get();
+    } catch (int) {
+        threw = true;
+    }
+    assert(threw);
+
+    // Move-only captures work with every task policy.
+    auto owned = std::make_unique<int>(11);
+    auto moved = pool.submit([p = std::move(owned)]() { return *p; });
+    assert(moved.has_value());
+    const int moved_value = moved->get();
+    assert(moved_value == 11);
+
+    constexpr int tasks = 5000;
+    std::atomic<int> counter{0};
+    for (int i = 0; i < tasks; ++i) {
+        const bool accepted =
+            pool.post([&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+        assert(accepted);
+    }
+    pool.shutdown();
+    assert(counter.load(std::memory_order_relaxed) == tasks);
+
+    auto rejected_submit = pool.submit([] { return 1; });
+    const bool rejected_post = !pool.post([] {});
+    assert(!rejected_submit.has_value());
+    assert(rejected_post);
+    assert(pool.is_shutdown());
+    assert(pool.get_stop_token().stop_requested());
+
+    auto stats = pool.stats();
+    assert(stats.workers == 3);
+    assert(stats.queued == 0);
+    if (counts_tasks) {
+        assert(stats.submitted == tasks + 3);
+        assert(stats.completed == tasks + 3);
+        assert(stats.rejected == 2);
+    } else {
+        assert(stats.submitted == 0 && stats.completed == 0 && stats.rejected == 0);
+    }
+}
+
+}  // namespace
+
+/// Validates BasicThreadPool across queue, idle, stats, and task policies.
+int main() {
+    using namespace tp::policy;
+
+    exercise<tp::BasicThreadPool<>>(true);
+    exercise<tp::BasicThreadPool<MutexQueue, BlockingIdle, NoStats, FunctionTask>>(false);
+    exercise<tp::BasicThreadPool<MutexQueue, BlockingIdle, AtomicStats, InplaceTask<64>>>(true);
+    exercise<tp::BasicThreadPool<RingQueue<64>, BlockingIdle, AtomicStats, FunctionTask>>(true);
+    exercise<tp::BasicThreadPool<RingQueue<1024>, SpinIdle, NoStats, InplaceTask<64>>>(false);
+
+    // The lean stats policy adds no storage to the pool.
+    static_assert(sizeof(tp::BasicThreadPool<MutexQueue, BlockingIdle, NoStats>) <
+                  sizeof(tp::BasicThreadPool<MutexQueue, BlockingIdle, AtomicStats>));
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <cassert>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "tp/thread_pool.hpp"
+
+namespace {
+
+void wait_until_retired(const tp::ThreadPool& pool) {
+    for (int i = 0; i < 1000 && pool.stats().compensating != 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+}  // namespace
+
+/// Validates BlockingScope compensation: a single-worker pool whose only worker
+/// blocks on work queued behind it must still make progress.
+int main() {
+    tp::ThreadPool pool(1);
+
+    std::promise<int> inner_result;
+    auto inner_future = inner_result.get_future();
+    auto outer = pool.submit([&pool, &inner_result, &inner_future]() {
+        tp::BlockingScope scope;
+        auto inner = pool.submit([&inner_result]() { inner_result.set_value(41); });
+        assert(inner.has_value());
+        return inner_future.get() + 1;
+    });
+    assert(outer.has_value());
+    const int outer_value = outer->get();
+    assert(outer_value == 42);
+
+    wait_until_retired(pool);
+    auto stats = pool.stats();
+    assert(stats.blocked == 0);
+    assert(stats.compensating == 0);
+    assert(stats.workers == 1);
+    assert(pool.worker_count() == 1);
+
+    // run_blocking does the same, and a parked compensating worker gets reused.
+    for (int round = 0; round < 3; ++round) {
+        std::promise<void> gate;
+        auto gate_future = gate.get_future().share();
+        auto waiter = pool.submit([&pool, gate_future]() {
+            return pool.run_blocking([gate_future]() {
+                gate_future.get();
+                return 7;
+            });
+        });
+        auto opener = pool.submit([&gate]() { gate.set_value(); });
+        assert(waiter.has_value() && opener.has_value());
+        opener->get();
+        const int waiter_value = waiter->get();
+        assert(waiter_value == 7);
+    }
+    wait_until_retired(pool);
+    assert(pool.stats().compensating == 0);
+
+    // Outside a pool worker the scope is a no-op.
+    {
+        tp::BlockingScope scope;
+        assert(pool.stats().blocked == 0);
+    }
+    const int doubled = pool.run_blocking([](int v) { return v * 2; }, 4);
+    assert(doubled == 8);
+
+    pool.shutdown();
+    return 0;
+}
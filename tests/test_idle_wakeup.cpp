@@ -0,0 +1,30 @@
+#include <cassert>
+#include <future>
+#include <optional>
+
+#include "tp/thread_pool.hpp"
+
+/// Regression test for lost idle wakeups: many short submit/get rounds keep
+/// workers falling asleep and being woken while peers race them for the task.
+/// A worker that goes back to sleep without re-marking itself idle can never be
+/// woken again; once every worker is in that state this test hangs.
+int main() {
+    tp::ThreadPool pool(4);
+
+    constexpr int rounds = 200000;
+    long long total = 0;
+    for (int r = 0; r < rounds; ++r) {
+        std::optional<std::future<int>> futures[3];
+        for (int i = 0; i < 3; ++i) {
+            futures[i] = pool.submit([i]() { return i; });
+            assert(futures[i].has_value());
+        }
+        for (auto& fut : futures) {
+            total += fut->get();
+        }
+    }
+
+    pool.shutdown();
+    assert(total == 3LL * rounds);
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <cassert>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "tp/future.hpp"
+#include "tp/thread_pool.hpp"
+
+/// Validates tp::Future/tp::Promise and submit<tp::Future>, including get() on a worker.
+int main() {
+    // Promise/future across threads.
+    {
+        tp::Promise<int> promise;
+        auto future = promise.get_future();
+        assert(future.valid() && !future.is_ready());
+        std::thread producer([&promise]() { promise.set_value(5); });
+        const int value = future.get();
+        assert(value == 5);
+        assert(!future.valid());
+        producer.join();
+    }
+
+    // Exceptions, broken promises, and void results.
+    {
+        tp::Promise<void> promise;
+        auto future = promise.get_future();
+        promise.set_exception(std::make_exception_ptr(std::runtime_error("boom")));
+        bool threw = false;
+        try {
+            future.get();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+
+        tp::Future<int> orphan;
+        {
+            tp::Promise<int> abandoned;
+            orphan = abandoned.get_future();
+        }
+        threw = false;
+        try {
+            orphan.get();
+        } catch (const std::future_error& e) {
+            threw = e.code() == std::future_errc::broken_promise;
+        }
+        assert(threw);
+    }
+
+    tp::ThreadPool pool(1);
+
+    auto sum = pool.submit<tp::Future>([](int a, int b) { return a + b; }, 3, 4);
+    assert(sum.has_value());
+    const int sum_value = sum->get();
+    assert(sum_value == 7);
+
+    auto owned = pool.submit<tp::Future>([]() { return std::make_unique<int>(9); });
+    assert(owned.has_value());
+    const auto owned_value = owned->get();
+    assert(*owned_value == 9);
+
+    auto failing = pool.submit<tp::Future>([]() -> int { throw std::logic_error("bad"); });
+    bool threw = false;
+    try {
+        failing->get();
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    assert(threw);
+
+    // With one worker, get() on that worker must run the inner task itself.
+    auto outer = pool.submit<tp::Future>([&pool]() {
+        auto inner = pool.submit<tp::Future>([]() { return 20; });
+        return inner->get() + 1;
+    });
+    assert(outer.has_value());
+    const int outer_value = outer->get();
+    assert(outer_value == 21);
+
+    auto affine = pool.submit_affine<tp::Future>(17, []() { return 3; });
+    assert(affine.has_value());
+    const int affine_value = affine->get();
+    assert(affine_value == 3);
+
+    std::vector<tp::Future<void>> futures;
+    for (int i = 0; i < 1000; ++i) {
+        auto fut = pool.submit<tp::Future>([] {});
+        assert(fut.has_value());
+        futures.push_back(std::move(*fut));
+    }
+    for (auto& fut : futures) {
+        fut.get();
+    }
+
+    // A dropped future must not leak or break the task.
+    pool.submit<tp::Future>([] { return 1; });
+
+    pool.shutdown();
+    auto rejected = pool.submit<tp::Future>([] { return 1; });
+    assert(!rejected.has_value());
+    auto stats = pool.stats();
+    assert(stats.submitted == stats.completed);
+    return 0;
+}
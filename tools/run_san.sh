@@ -31,3 +31,9 @@ cmake --build "$build_dir" -j
 "$build_dir/test_basic"
 "$build_dir/test_future"
 "$build_dir/test_shutdown"
+"$build_dir/test_affinity"
+"$build_dir/test_idle_wakeup"
+"$build_dir/test_algorithms"
+"$build_dir/test_basic_thread_pool"
+"$build_dir/test_blocking"
+"$build_dir/test_tp_future"